@@ -12,7 +12,7 @@ from networkx.classes.function import (
     non_edges,
 )
 
-from src.data.utils import apx2nxgraph, nxgraph2apx
+from src.data.utils import afb2nxgraph, apx2nxgraph, nxgraph2afb, nxgraph2apx
 
 
 class ArgumentationFramework:
@@ -42,6 +42,13 @@ class ArgumentationFramework:
 
         return cls(graph, graph_id)
 
+    @classmethod
+    def from_afb(cls, afb: bytes, graph_id=None):
+        """
+        Initialize object from the binary AF format of pakota and maadoita
+        """
+        return cls(afb2nxgraph(afb), graph_id)
+
     def __init__(self, graph: DiGraph, graph_id=None, extensions=None):
         self.extensions = extensions if extensions is not None else {}
         self.graph = graph
@@ -51,6 +58,10 @@ class ArgumentationFramework:
         """ Make an apx from the AF """
         return nxgraph2apx(self.graph)
 
+    def to_afb(self) -> bytes:
+        """ Make a binary AF (see BinaryAF.h of pakota and maadoita) from the AF """
+        return nxgraph2afb(self.graph)
+
     def edge_difference(self, other_af: ArgumentationFramework) -> Set[tuple]:
         """ Set of edge differences between two AFs"""
         edges1 = set(self.graph.edges)
@@ -58,6 +58,10 @@ class ArgumentationProblem:
         apx = self.af.to_apx()
         return apx
 
+    def to_afb(self) -> bytes:
+        """ Convert problem to the binary AF format of pakota and maadoita """
+        return self.af.to_afb()
+
     @property
     def optimal_solution(self):
         if not self.optimal_solver or self.optimal_solver not in self.solutions:
@@ -9,6 +9,7 @@ from typing import Optional, Dict, List, TYPE_CHECKING
 from src.constants import STRICT, NONSTRICT, SCEPT, CRED
 from src.data.classes.argumentation_framework import ArgumentationFramework
 from src.data.classes.problems.argumentation_problem import ArgumentationProblem
+from src.data.utils import nxgraph2afb
 
 if TYPE_CHECKING:
     from src.data.solvers.enforcement_solver import EnforcementSolver
@@ -125,6 +126,9 @@ class ExtensionEnforcementProblem(EnforcementProblem):
             apx += f"enf({argument}).\n"
         return apx
 
+    def to_afb(self):
+        return nxgraph2afb(self.af.graph, enforced=self.desired_extension)
+
     def __str__(self):
         return f"Enforce desired extension: {self.desired_extension}"
 
@@ -190,5 +194,8 @@ class StatusEnforcementProblem(EnforcementProblem):
             apx += f"pos({argument}).\n"
         return apx
 
+    def to_afb(self):
+        return nxgraph2afb(self.af.graph, enforced=self.positive, negative=self.negative, status=True)
+
     def __str__(self):
         return f"Enforce desired status. Negative: {self.negative}. Positive: {self.positive}"
@@ -0,0 +1,238 @@
+from __future__ import annotations
+
+import ctypes
+import re
+from pathlib import Path
+from typing import Callable, List, Optional, Set, Tuple, Union
+
+ATTACK_PATTERN = re.compile(r"([+-])att\((.+?),(.+?)\)")
+
+
+class EnforcementResult:
+    """
+    Result line of the batch mode / C API of pakota and maadoita:
+    <status> <cost> <iterations> <time> -att(a,b) ... +att(c,d) ...
+    In anytime mode, the proven lower bound on the cost follows the time (except on errors).
+    The time is the wall clock time of solving the instance in seconds
+    """
+
+    def __init__(self, line: str, anytime: bool = False):
+        fields = line.split()
+        self.status = fields[0]
+        anytime = anytime and self.status != "error"
+        self.cost = int(fields[1])
+        self.iterations = int(fields[2])
+        self.time = float(fields[3])
+        self.lower_bound = int(fields[4]) if anytime else None
+        self.removed, self.added = set(), set()
+        for sign, attacker, attacked in ATTACK_PATTERN.findall(" ".join(fields[5 if anytime else 4:])):
+            attack = (self._argument(attacker), self._argument(attacked))
+            (self.added if sign == "+" else self.removed).add(attack)
+
+    @staticmethod
+    def _argument(name: str):
+        """ Arguments of the AFs are integers, other names are kept as strings """
+        return int(name) if name.isdigit() else name
+
+    @property
+    def optimal(self) -> bool:
+        return self.status == "optimum"
+
+    @property
+    def feasible(self) -> bool:
+        """ A solution was found, possibly not proven optimal (anytime mode) """
+        return self.status in ("optimum", "feasible")
+
+    @property
+    def gap(self) -> Optional[int]:
+        """ Number of changes above the proven lower bound (anytime mode) """
+        if not self.feasible or self.lower_bound is None:
+            return None
+        return self.cost - self.lower_bound
+
+    @property
+    def edge_changes(self) -> Set[Tuple]:
+        return self.removed | self.added
+
+
+SOLUTION_CALLBACK = ctypes.CFUNCTYPE(None, ctypes.c_int, ctypes.c_char_p, ctypes.c_void_p)
+
+
+class PakotaOptions(ctypes.Structure):
+    """ struct pakota_options of pakota's Library.h """
+    _fields_ = [
+        ("data", ctypes.c_char_p), ("size", ctypes.c_int), ("input", ctypes.c_int),
+        ("mode", ctypes.c_char_p), ("sem", ctypes.c_char_p), ("incremental", ctypes.c_int),
+        ("threads", ctypes.c_int), ("portfolio", ctypes.c_int), ("gap", ctypes.c_int),
+        ("time_limit", ctypes.c_double),
+        ("solution", SOLUTION_CALLBACK), ("user", ctypes.c_void_p),
+    ]
+
+
+class MaadoitaOptions(ctypes.Structure):
+    """ struct maadoita_options of maadoita's Library.h """
+    _fields_ = [
+        ("data", ctypes.c_char_p), ("size", ctypes.c_int), ("input", ctypes.c_int),
+        ("mode", ctypes.c_char_p), ("cegar", ctypes.c_int), ("incremental", ctypes.c_int),
+        ("threads", ctypes.c_int), ("portfolio", ctypes.c_int), ("gap", ctypes.c_int),
+        ("time_limit", ctypes.c_double),
+        ("solution", SOLUTION_CALLBACK), ("user", ctypes.c_void_p),
+    ]
+
+
+class EnforcementLibrary:
+    """
+    In-process interface to libpakota.so and libmaadoita.so (build with
+    `make libpakota.so` / `make libmaadoita.so` in the solver sources)
+    """
+
+    INSTANCE, BATCH = 0, 1
+
+    def __init__(self, path: Path, prefix: str, options: type):
+        self.prefix = prefix
+        self.options = options
+        self.library = ctypes.CDLL(str(path))
+        getattr(self.library, f"{prefix}_free").argtypes = [ctypes.c_void_p]
+        getattr(self.library, f"{prefix}_free").restype = None
+        getattr(self.library, f"{prefix}_default_options").argtypes = [ctypes.POINTER(options)]
+        getattr(self.library, f"{prefix}_default_options").restype = None
+        getattr(self.library, f"{prefix}_run").argtypes = [ctypes.POINTER(options)]
+        getattr(self.library, f"{prefix}_run").restype = ctypes.c_void_p
+
+    @classmethod
+    def pakota(cls, path: Optional[Path] = None) -> EnforcementLibrary:
+        if path is None:
+            path = Path(__file__).parent / "vendor/pakota/sources/libpakota.so"
+        return cls(path, "pakota", PakotaOptions)
+
+    @classmethod
+    def maadoita(cls, path: Optional[Path] = None) -> EnforcementLibrary:
+        if path is None:
+            path = Path(__file__).parent / "vendor/maadoita/sources/libmaadoita.so"
+        return cls(path, "maadoita", MaadoitaOptions)
+
+    def _run(self, data: bytes, kind: int, time_limit: Optional[float], anytime_gap: Optional[int],
+             on_solution: Optional[Callable[[int, str], None]], **fields) -> str:
+        """ Calls <prefix>_run with the default options, overridden by the given ones """
+        options = self.options()
+        getattr(self.library, f"{self.prefix}_default_options")(ctypes.byref(options))
+        options.data, options.size, options.input = data, len(data), kind
+        options.time_limit = time_limit if time_limit is not None else 0
+        options.gap = anytime_gap if anytime_gap is not None else -1
+        if on_solution is not None:
+            options.solution = SOLUTION_CALLBACK(lambda instance_id, line, user: on_solution(instance_id, line.decode()))
+        for name, value in fields.items():
+            setattr(options, name, value)
+        pointer = getattr(self.library, f"{self.prefix}_run")(ctypes.byref(options))
+        try:
+            return ctypes.string_at(pointer).decode()
+        finally:
+            getattr(self.library, f"{self.prefix}_free")(pointer)
+
+    def solve(self, apx: Union[str, bytes], mode: str, sem: Optional[str] = None,
+              cegar: bool = False, time_limit: Optional[float] = None,
+              portfolio: int = 1, anytime_gap: Optional[int] = None,
+              on_solution: Optional[Callable[[str], None]] = None) -> EnforcementResult:
+        """
+        Solve a single instance, given in apx format or as bytes in apx or binary format
+        (see nxgraph2afb). sem is only used by pakota and cegar only by maadoita.
+        With portfolio > 1, the instance is solved by that many MaxSAT solver configurations
+        in parallel, and the first optimal result is returned.
+        With anytime_gap, the search stops as soon as the best solution is within anytime_gap
+        changes of the proven lower bound, and at the time limit the best solution found so far
+        is returned with status "feasible". on_solution is then called with the line
+        "o <cost> <lower bound> <time> <changes>" of each improving solution
+        """
+        data = apx if isinstance(apx, bytes) else apx.encode()
+        task = {"sem": sem.encode()} if self.prefix == "pakota" else {"cegar": int(cegar)}
+        callback = None if on_solution is None else lambda instance_id, line: on_solution(line)
+        line = self._run(data, self.INSTANCE, time_limit, anytime_gap, callback,
+                         mode=mode.encode(), portfolio=portfolio, **task)
+        return EnforcementResult(line, anytime=anytime_gap is not None)
+
+    def solve_batch(self, instances: List[Tuple], threads: int = 1, cegar: bool = False,
+                    time_limit: Optional[float] = None, anytime_gap: Optional[int] = None,
+                    on_solution: Optional[Callable[[int, str], None]] = None
+                    ) -> List[Optional[EnforcementResult]]:
+        """
+        Solve instances concurrently on a pool of threads. Each instance is a tuple
+        (apx, mode, sem) for pakota or (apx, mode) for maadoita, apx as in solve().
+        anytime_gap is as in solve(), and on_solution is called with the index of the instance
+        and the line of each improving solution.
+        Returns the results in the order of the instances (None for malformed instances)
+        """
+        records = []
+        for instance in instances:
+            apx = instance[0] if isinstance(instance[0], bytes) else instance[0].encode()
+            header = " ".join(instance[1:]).encode()
+            records.append(header + b" %d\n" % len(apx) + apx)
+        task = {} if self.prefix == "pakota" else {"cegar": int(cegar)}
+        callback = None if on_solution is None else lambda instance_id, line: on_solution(instance_id - 1, line)
+        output = self._run(b"".join(records), self.BATCH, time_limit, anytime_gap, callback,
+                           threads=threads, **task)
+
+        results = [None] * len(instances)
+        for line in output.splitlines():
+            instance_id, result = line.split(" ", 1)
+            results[int(instance_id) - 1] = EnforcementResult(result, anytime=anytime_gap is not None)
+        return results
+
+
+class GroundedLabeling:
+    """
+    Incremental grounded labeling of an AF with arguments 0..n_args-1, maintained
+    by maadoita under additions and removals of attacks (see maadoita's Library.h).
+    Labels are 1 (accepted), -1 (rejected) or 0 (undecided)
+    """
+
+    def __init__(self, library: EnforcementLibrary, n_args: int,
+                 attacks: Optional[List[Tuple[int, int]]] = None):
+        self.library = library.library
+        self.library.maadoita_grounded_new.argtypes = [ctypes.c_int]
+        self.library.maadoita_grounded_new.restype = ctypes.c_void_p
+        self.library.maadoita_grounded_update.argtypes = [
+            ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.c_int,
+            ctypes.POINTER(ctypes.c_int), ctypes.c_int
+        ]
+        self.library.maadoita_grounded_update.restype = ctypes.c_int
+        self.library.maadoita_grounded_labels.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int)]
+        self.library.maadoita_grounded_labels.restype = ctypes.c_int
+        self.library.maadoita_grounded_delete.argtypes = [ctypes.c_void_p]
+        self.library.maadoita_grounded_delete.restype = None
+
+        if n_args < 0:
+            raise ValueError(f"Negative number of arguments: {n_args}")
+        self.n_args = n_args
+        self.labeling = self.library.maadoita_grounded_new(n_args)
+        if attacks:
+            self.update(added=attacks)
+
+    def __del__(self):
+        if getattr(self, "labeling", None):
+            self.library.maadoita_grounded_delete(self.labeling)
+            self.labeling = None
+
+    @staticmethod
+    def _attacks(attacks: List[Tuple[int, int]]):
+        flat = [argument for attack in attacks for argument in attack]
+        return (ctypes.c_int * len(flat))(*flat), len(attacks)
+
+    def update(self, added: List[Tuple[int, int]] = (), removed: List[Tuple[int, int]] = ()):
+        """ Raises ValueError (and changes nothing) if an argument is not in 0..n_args-1 """
+        added, removed = list(added), list(removed)
+        for attack in added + removed:
+            if not all(0 <= argument < self.n_args for argument in attack):
+                raise ValueError(f"Attack {attack} is not between arguments 0..{self.n_args - 1}")
+        if self.library.maadoita_grounded_update(self.labeling, *self._attacks(added),
+                                                 *self._attacks(removed)) != 0:
+            raise ValueError("Attack between arguments out of range")
+
+    @property
+    def labels(self) -> List[int]:
+        labels = (ctypes.c_int * self.n_args)()
+        self.library.maadoita_grounded_labels(self.labeling, labels)
+        return list(labels)
+
+    @property
+    def extension(self) -> Set[int]:
+        return {argument for argument, label in enumerate(self.labels) if label == 1}
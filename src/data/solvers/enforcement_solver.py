@@ -5,7 +5,7 @@ import resource
 import subprocess
 import tempfile
 from pathlib import Path
-from typing import Union
+from typing import List, Optional, Union
 
 from src.constants import PRF, COM, STB, STRICT, NONSTRICT, CRED, SCEPT, GRD
 from src.data.classes.argumentation_framework import ArgumentationFramework
@@ -13,6 +13,7 @@ from src.data.classes.problems.enforcement_problem import (
     StatusEnforcementProblem,
     ExtensionEnforcementProblem,
 )
+from src.data.solvers.enforcement_library import EnforcementLibrary
 
 
 class EnforcementSolver:
@@ -109,3 +110,56 @@ class EnforcementSolver:
         edge_changes = modified_af.edge_difference(problem.af)
 
         return num_changes, solve_time, edge_changes
+
+    def solve_batch(
+            self,
+            problems: List[Union[ExtensionEnforcementProblem, StatusEnforcementProblem]],
+            semantics,
+            time_limit=None,
+            threads=1,
+            anytime_gap: Optional[int] = None,
+    ):
+        """
+        Solve problems in-process with the C API of pakota / maadoita,
+        concurrently on a pool of threads with a time limit per problem.
+        Returns a (num_changes, solve_time, edge_changes) tuple per problem, and records the
+        problems that reach the time limit in the same way as solve(). Unlike the CPU time
+        of solve(), solve_time is the wall clock time of solving the problem.
+        With anytime_gap, a problem stops as soon as its best solution is within anytime_gap
+        changes of optimal, and a problem that reaches the time limit is labeled with the best
+        solution found so far instead of None.
+        """
+        if semantics == GRD:
+            library = EnforcementLibrary.maadoita()
+            modes = {STRICT: "strict", NONSTRICT: "non-strict"}
+        else:
+            library = EnforcementLibrary.pakota()
+            modes = {STRICT: "strict", NONSTRICT: "non-strict", CRED: "cred", SCEPT: "skept"}
+
+        instances, indices = [], []
+        for index, problem in enumerate(problems):
+            if isinstance(problem, StatusEnforcementProblem) and semantics == GRD:
+                continue
+            if problem.task == SCEPT and semantics != STB:
+                continue
+            instance = (problem.to_afb(), modes[problem.task])
+            if semantics != GRD:
+                instance += (self.semantics_conversion[semantics],)
+            instances.append(instance)
+            indices.append(index)
+
+        solutions = [(None, 0, None)] * len(problems)
+        results = library.solve_batch(
+            instances, threads=threads, time_limit=time_limit, anytime_gap=anytime_gap
+        )
+        for index, result in zip(indices, results):
+            if result is None or result.status == "error":
+                raise Exception(f"Enforcement of problem {index} failed")
+            if result.feasible:
+                solutions[index] = (result.cost, result.time, result.edge_changes)
+            else:
+                problem = problems[index]
+                problem.solutions.setdefault(self.name, {}).update({semantics: None})
+                problem.solve_times.setdefault(self.name, {}).update({semantics: time_limit})
+                problem.edge_changes.setdefault(self.name, {}).update({semantics: None})
+        return solutions
@@ -1,10 +1,15 @@
 import re
-from typing import TextIO, Union
+import struct
+from typing import Iterable, TextIO, Tuple, Union
 
 import networkx as nx
 from networkx.classes.digraph import DiGraph
 
 
+AFB_MAGIC = b'AFB1'
+AFB_STATUS, AFB_RESULT = 1, 2
+
+
 def nxgraph2apx(graph: DiGraph) -> str:
     apx = ''
     for argument in graph.nodes:
@@ -33,3 +38,61 @@ def apx2nxgraph(apx: Union[list, TextIO]) -> DiGraph:
             graph.add_edge(conversion[attack[0]], conversion[attack[1]])
 
     return graph
+
+
+def nxgraph2afb(graph: DiGraph, enforced: Iterable = (), negative: Iterable = (),
+                status: bool = False) -> bytes:
+    """
+    Binary AF format of pakota and maadoita (see BinaryAF.h in the solver sources).
+    Enforced arguments are enf predicates, or pos predicates if status is set
+    """
+    index = {argument: i for i, argument in enumerate(graph.nodes)}
+    enforced = [index[argument] for argument in enforced]
+    negative = [index[argument] for argument in negative]
+    offsets, targets = [0] * (len(index) + 1), [[] for _ in index]
+    for attacker, attacked in graph.edges:
+        targets[index[attacker]].append(index[attacked])
+    for i, attacked in enumerate(targets):
+        offsets[i + 1] = offsets[i] + len(attacked)
+    names = [str(argument).encode() for argument in graph.nodes]
+    name_offsets = [0] * (len(names) + 1)
+    for i, name in enumerate(names):
+        name_offsets[i + 1] = name_offsets[i] + len(name)
+
+    header = struct.pack('<5IiI', AFB_STATUS if status else 0, len(index), offsets[-1],
+                         len(enforced), len(negative), -1, name_offsets[-1])
+    values = offsets + [target for attacked in targets for target in attacked]
+    values += enforced + negative + name_offsets
+    return AFB_MAGIC + header + struct.pack(f'<{len(values)}I', *values) + b''.join(names)
+
+
+def afb_header(afb: bytes) -> dict:
+    """ Flags, counts and cost (-1 unless a result) of an AF in binary format """
+    if afb[:4] != AFB_MAGIC:
+        raise ValueError('Not an AF in binary format')
+    flags, n_args, n_atts, n_enfs, n_neg_enfs, cost, names_size = struct.unpack_from('<5IiI', afb, 4)
+    return dict(flags=flags, n_args=n_args, n_atts=n_atts, n_enfs=n_enfs, n_neg_enfs=n_neg_enfs,
+                cost=cost, names_size=names_size)
+
+
+def afb2nxgraph(afb: bytes) -> DiGraph:
+    """ Arguments are numbered 0..n-1 in the order of the file, as in apx2nxgraph """
+    header = afb_header(afb)
+    n_args = header['n_args']
+    offsets = struct.unpack_from(f'<{n_args + 1}I', afb, 32)
+    targets = struct.unpack_from(f'<{header["n_atts"]}I', afb, 32 + 4 * (n_args + 1))
+
+    graph = nx.DiGraph()
+    graph.add_nodes_from(range(n_args))
+    graph.add_edges_from((attacker, targets[j]) for attacker in range(n_args)
+                         for j in range(offsets[attacker], offsets[attacker + 1]))
+    return graph
+
+
+def afb_enforcements(afb: bytes) -> Tuple[list, list]:
+    """ Enforced (enf or pos) and negative arguments of an AF in binary format, numbered as in afb2nxgraph """
+    header = afb_header(afb)
+    start = 32 + 4 * (header['n_args'] + 1 + header['n_atts'])
+    enforced = struct.unpack_from(f'<{header["n_enfs"]}I', afb, start)
+    negative = struct.unpack_from(f'<{header["n_neg_enfs"]}I', afb, start + 4 * header['n_enfs'])
+    return list(enforced), list(negative)
@@ -2,13 +2,22 @@ import random
 import shutil
 import subprocess
 
+import networkx as nx
+import pytest
+
 from src import config
 from src.constants import *
 from src.data.classes.argumentation_framework import ArgumentationFramework
-from src.data.classes.problems.enforcement_problem import EnforcementProblem
+from src.data.classes.problems.enforcement_problem import (
+    EnforcementProblem,
+    ExtensionEnforcementProblem,
+    StatusEnforcementProblem,
+)
 from src.data.solvers.acceptance_verifier import AcceptanceVerifier
+from src.data.solvers.enforcement_library import EnforcementLibrary, EnforcementResult, GroundedLabeling
 from src.data.solvers.enforcement_solver import EnforcementSolver
 from src.data.solvers.enumeration_solver import EnumerationSolver
+from src.data.utils import afb2nxgraph, afb_enforcements, afb_header, nxgraph2afb, nxgraph2apx
 from src.experiment.reinforcement.enforcement_env import EnforcementEnv
 
 dataset_name = "pytest"
@@ -123,6 +132,124 @@ def test_enforcement_generation():
                     assert len(enf_problem.negative.intersection(accepted)) == 0
 
 
+def test_grounded_labeling():
+    """ Test if the incremental grounded labeling agrees with one computed from scratch
+     after random additions and removals of attacks """
+    library = EnforcementLibrary.maadoita()
+    rng = random.Random(0)
+    for _ in range(20):
+        n_args = rng.randint(1, 15)
+        attacks = set()
+        labeling = GroundedLabeling(library, n_args)
+        for _ in range(30):
+            pairs = {(rng.randrange(n_args), rng.randrange(n_args)) for _ in range(rng.randint(0, 5))}
+            added = [attack for attack in pairs if attack not in attacks]
+            removed = rng.sample(sorted(attacks), rng.randint(0, min(3, len(attacks))))
+            labeling.update(added=added, removed=removed)
+            attacks = (attacks | set(added)) - set(removed)
+            assert labeling.labels == GroundedLabeling(library, n_args, sorted(attacks)).labels
+
+        with pytest.raises(ValueError):
+            labeling.update(added=[(0, n_args)])
+        assert labeling.labels == GroundedLabeling(library, n_args, sorted(attacks)).labels
+
+
+def test_afb_format():
+    """ Test if AFs with enforcements survive the binary format
+     and if pakota and maadoita solve the same instance in binary and apx format at the same cost """
+    pakota, maadoita = EnforcementLibrary.pakota(), EnforcementLibrary.maadoita()
+
+    def same_optimum(result, other):
+        return result.optimal and other.optimal and result.cost == other.cost
+
+    rng = random.Random(0)
+    for _ in range(10):
+        graph = nx.gnp_random_graph(rng.randint(2, 8), 0.3, seed=rng.randrange(1000), directed=True)
+        arguments = list(graph.nodes)
+        enforced = rng.sample(arguments, rng.randint(1, len(arguments) // 2))
+        negative = rng.sample([argument for argument in arguments if argument not in enforced], 1)
+
+        for status in [False, True]:
+            afb = nxgraph2afb(graph, enforced=enforced, negative=negative if status else (), status=status)
+            assert afb_header(afb)['flags'] == (1 if status else 0)
+            assert set(afb2nxgraph(afb).nodes) == set(graph.nodes)
+            assert set(afb2nxgraph(afb).edges) == set(graph.edges)
+            assert afb_enforcements(afb) == (enforced, negative if status else [])
+
+        apx = nxgraph2apx(graph) + "".join(f"enf({argument}).\n" for argument in enforced)
+        afb = nxgraph2afb(graph, enforced=enforced)
+        for mode in ["strict", "non-strict"]:
+            for sem in ["adm", "com", "stb", "prf"]:
+                assert same_optimum(pakota.solve(afb, mode, sem), pakota.solve(apx, mode, sem))
+            assert same_optimum(maadoita.solve(afb, mode), maadoita.solve(apx, mode))
+
+        # in anytime mode, the last improving solution reported for each instance is the optimum
+        solutions = {}
+        results = maadoita.solve_batch([(afb, "strict"), (apx, "non-strict")], cegar=True, anytime_gap=0,
+                                       on_solution=lambda index, line: solutions.update({index: line}))
+        for index, result in enumerate(results):
+            assert result.optimal and int(solutions[index].split()[1]) == result.cost
+
+        apx = nxgraph2apx(graph) + "".join(f"pos({argument}).\n" for argument in enforced)
+        apx += "".join(f"neg({argument}).\n" for argument in negative)
+        afb = nxgraph2afb(graph, enforced=enforced, negative=negative, status=True)
+        for mode, sem in [("cred", "stb"), ("cred", "prf"), ("skept", "stb")]:
+            assert same_optimum(pakota.solve(afb, mode, sem), pakota.solve(apx, mode, sem))
+
+
+def test_enforcement_batch():
+    """ Test if solving in batch gives the optimal costs of solving one problem at a time,
+     and the outcomes of timeouts and errors """
+    enf_solver = EnforcementSolver()
+    rng = random.Random(0)
+    problems = []
+    for _ in range(4):
+        af = ArgumentationFramework(nx.gnp_random_graph(8, 0.3, seed=rng.randrange(1000), directed=True))
+        arguments = sorted(af.arguments)
+        enforced = frozenset(rng.sample(arguments, 3))
+        for task in [STRICT, NONSTRICT]:
+            problems.append(ExtensionEnforcementProblem(af=af, task=task, desired_extension=enforced))
+        for task in [CRED, SCEPT]:
+            problems.append(StatusEnforcementProblem(af=af, task=task, positive=frozenset(list(enforced)[:2]),
+                                                     negative=frozenset(list(enforced)[2:])))
+
+    for semantics in [GRD, STB, PRF]:
+        batch = enf_solver.solve_batch(problems, semantics, threads=2)
+        for problem, (num_changes, _, edge_changes) in zip(problems, batch):
+            assert num_changes == enf_solver.solve(problem, semantics)[0]
+            assert num_changes is None or len(edge_changes) == num_changes
+
+    af = ArgumentationFramework(nx.gnp_random_graph(150, 0.05, seed=0, directed=True))
+    problem = ExtensionEnforcementProblem(af=af, task=NONSTRICT, desired_extension=frozenset(range(0, 150, 10)))
+    assert enf_solver.solve_batch([problem], STB, time_limit=0.5) == [(None, 0, None)]
+    assert problem.solve_times[enf_solver.name][STB] == 0.5 and problem.solutions[enf_solver.name][STB] is None
+
+    # an extension enforcement problem does not have the positive arguments of a credulous one
+    problem = ExtensionEnforcementProblem(af=af, task=CRED, desired_extension=frozenset([0]))
+    with pytest.raises(Exception):
+        enf_solver.solve_batch([problem], STB)
+
+    # unsatisfiable instances and instances without arguments are errors, not crashes of the process
+    pakota, maadoita = EnforcementLibrary.pakota(), EnforcementLibrary.maadoita()
+    assert pakota.solve_batch([("arg(a).\n", "strict", "stb")])[0].status == "error"
+    assert maadoita.solve_batch([("arg(a).\n", "strict")])[0].status == "error"
+    assert pakota.solve_batch([("garbage\n", "strict", "stb")])[0].status == "error"
+    assert maadoita.solve_batch([("garbage\n", "strict")])[0].status == "error"
+    assert pakota.solve_batch([("", "strict", "stb")])[0].status == "error"
+
+    result = EnforcementResult("optimum 2 3 0.010 -att(1,2) +att(a,3)")
+    assert (result.status, result.cost, result.iterations, result.time) == ("optimum", 2, 3, 0.01)
+    assert result.removed == {(1, 2)} and result.added == {("a", 3)}
+    assert result.optimal and result.feasible and result.gap is None
+    result = EnforcementResult("feasible 5 4 1.000 3 -att(0,1)", anytime=True)
+    assert result.lower_bound == 3 and result.gap == 2 and result.edge_changes == {(0, 1)}
+    assert result.feasible and not result.optimal
+    result = EnforcementResult("timeout -1 1 0.500 4", anytime=True)
+    assert not result.feasible and result.lower_bound == 4 and result.edge_changes == set()
+    result = EnforcementResult("error -1 0 0.000", anytime=True)
+    assert not result.feasible and result.lower_bound is None
+
+
 def test_supervised_experiments():
     cmd = ["python", "-m", "src.experiment.supervised.sl_experiment", "--tag", "pytest", "--val_ds", "pytest",
            "--test_ds", "pytest", "--fast_dev_run", "1", "--batch_size", "2"]